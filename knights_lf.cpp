@@ -19,6 +19,7 @@ Finally, a counter is maintained to keep track of progress. When the counter rea
 
 #define MAXSIZE 25
 #define MINSIZE 6
+#define MAXBACKTRACKS 1000		// How long to search for a closed tour from one start before trying the next.
 
 
 //////
@@ -32,6 +33,12 @@ void removepossible (int source, int target);		// Removes source from target's l
 void backtrack();									// Moves backward in the knight's tour, called when the algorithm hits a dead end.
 void printResult();									// Prints the knight's tour in order of visitation.
 void printAll();									// Prints the knight's tour by space number.
+bool findtour(int start, bool closed);				// Runs the least freedom algorithm from start until a tour (closed, if asked for) is found.
+bool ismove(int source, int target);				// Checks to see if a knight can move from source to target.
+bool cantour(int start);							// Checks to see if the colour of start allows a tour from it.
+void startat(int start);							// Puts the knight on start, as the first space of a tour.
+void recordtour();									// Copies the tour just found into the tour array, in order of visitation.
+void allStarts();									// Prints a knight's tour from every starting point.
 
 int here;
 int n;
@@ -44,7 +51,10 @@ int ipossibles[MAXSIZE*MAXSIZE];
 int travelled[MAXSIZE*MAXSIZE][8];
 int itravelled[MAXSIZE*MAXSIZE];
 bool visited[MAXSIZE*MAXSIZE];
+int tour[MAXSIZE*MAXSIZE];
+int itour[MAXSIZE*MAXSIZE];
 
+#ifndef KNIGHTS_BENCH
 int main () {
 	
 	while ((w>MAXSIZE)||(w<MINSIZE)) {
@@ -60,29 +70,28 @@ int main () {
 	
 	initialize();
 
-	in = 0;
-	here = -1;
-	while ((here<0)||(here>=n)) {
-		cout << "\nChoose starting point: ";
-		cin >> here;
-	}
-	visit(here);
-	lasts[here] = -1;
-	
-	while (in < n) {
-		int next = findnext();
-		if (next >= 0) {
-			visit(next);
-		} else {
-			backtrack();
-		};
+	int start = -2;
+	while ((start<-1)||(start>=n)) {
+		cout << "\nChoose starting point (-1 for every starting point): ";
+		cin >> start;
 	}
+	if (start == -1) {
+		allStarts();
+		cout << "\n Done.";
+		return 0;
+	};
+	if (!(findtour(start, false))) {
+		cout << "\nNo tour exists from " << start;
+		cout << "\n Done.";
+		return 0;
+	};
 	
 	printResult();
 	
 	cout << "\n Done.";	
 	
 }
+#endif
 
 int findnext() { 					// Executes the least freedom algorithm by determining which space to move to next.
 	int tempnext = -1;				// Tempnext/tempi represent the possible place to move to next.
@@ -148,9 +157,7 @@ void backtrack() {									// Moves backward in the knight's tour, called when t
 	for (int i = 0; i < itravelled[here]; i++) {				// Resets list of locations travelled to from here.
 		travelled[here][i] = -1;								// to -1.
 	};
-	itravelled[here] = 0;
-	travelled[lasts[here]][itravelled[lasts[here]]] = here;		// Adds here to the end of the list of places travelled to from the previous place.
-	itravelled[lasts[here]]++;									// Increments the endpoint of that list.
+	itravelled[here] = 0;										// Here is already on the previous place's travelled list, since visit() put it there.
 
 	for (int i = 0; i < ipossibles[here]; i++) {				// Adds this point back to the list of possibles of all adjacent points.
 		int there = possibles[here][i];							// using a temp. integer called there to make syntax more readable.
@@ -233,4 +240,105 @@ void printAll() {
 	for (int i = 0; i < n; i++) {
 		cout << "\n The element behind " << i << " is " << lasts[i];
 	}
-}
\ No newline at end of file
+}
+
+bool findtour(int start, bool closed) {		// Runs the least freedom algorithm from start until a tour (closed, if asked for) is found.
+	int backtracks = 0;
+	int reserved = -1;
+	if (!(cantour(start))) {
+		return false;
+	};
+	startat(start);
+	if (closed) {				// A closed tour has to finish one move away from start, so one of start's neighbours is held back
+		reserved = possibles[start][ipossibles[start]-1];	// to be the last space, by marking it visited until then.
+		visited[reserved] = true;
+	};
+	
+	while (in < n) {
+		int next;
+		if ((closed)&&(in == n-1)) {				// Everything but the reserved space has been visited, so go there if it's in reach.
+			next = (ismove(here,reserved) ? reserved : -1);
+			if (next >= 0) {
+				visited[reserved] = false;
+			};
+		} else if ((closed)&&(ipossibles[reserved] == 0)) {	// Nothing left to reach the reserved space from, so this can't close.
+			next = -1;
+		} else {
+			next = findnext();
+		};
+		if (next >= 0) {
+			visit(next);
+		} else if (lasts[here] < 0) {		// Backtracking out of the start means every route from it has been tried.
+			return false;
+		} else if ((closed)&&(backtracks >= MAXBACKTRACKS)) {
+			return false;
+		} else {
+			backtrack();
+			backtracks++;
+		};
+	}
+	return true;
+}
+
+bool cantour(int start) {						// Checks to see if the colour of start allows a tour from it.
+	if ((n % 2) == 0) {
+		return true;
+	};
+	return ((((start % w) + (start / w)) % 2) == 0);	// On an odd board there is one less space of the colour the corners
+}														// aren't, and the knight alternates colours, so a tour can't start on one.
+
+void startat(int start) {						// Puts the knight on start, as the first space of a tour.
+	in = 1;										// This is visit() without the move into start, so start's travelled list
+	here = start;								// only ever holds the moves out of it.
+	visited[start] = true;
+	lasts[start] = -1;
+	for (int i = 0; i < ipossibles[start]; i++) {
+		removepossible(possibles[start][i],start);
+	}
+}
+
+bool ismove(int source, int target) {			// Checks to see if a knight can move from source to target.
+	int dx = abs((source % w) - (target % w));
+	int dy = abs((source / w) - (target / w));
+	return (((dx == 1)&&(dy == 2))||((dx == 2)&&(dy == 1)));
+}
+
+void recordtour() {									// Copies the tour just found into the tour array, in order of visitation.
+	int loc = here;
+	for (int i = n-1; i >= 0; i--) {				// Walk back from the end of the tour, filling the array from the back.
+		tour[i] = loc;
+		itour[loc] = i;								// itour records where each space appears in the tour.
+		loc = lasts[loc];
+	};
+}
+
+/*
+allStarts finds a knight's tour from every space on the board. Rather than searching n times, it looks for one closed tour. Since a closed tour finishes one move away from where it started, it is a cycle through every space, and a tour from any space is just that cycle read starting from that space. Each start is then answered in O(n) with no further searching.
+
+A board where both sides are odd has no closed tour (each move changes the colour of the space, so a cycle needs an even number of spaces), and the search is skipped. Every other board at least MINSIZE wide has one. Each start is given MAXBACKTRACKS to find it before moving on to the next, and only if none of them do is each start searched for separately. On a board with both sides odd, findtour gives up straight away on spaces not the colour of the corners.
+*/
+void allStarts() {
+	bool closed = false;
+	for (int start = 0; ((n % 2) == 0)&&(start < n)&&(!(closed)); start++) {	// Short searches from many starts find one
+		initialize();															// much sooner than one long search does.
+		closed = findtour(start, true);
+	};
+	if (closed) {
+		recordtour();
+	};
+	
+	for (int start = 0; start < n; start++) {
+		if (!(closed)) {
+			initialize();
+			if (!(findtour(start, false))) {
+				cout << "\nNo tour exists from " << start;
+				continue;
+			};
+			recordtour();
+		};
+		cout << "\nTour from " << start << ":";
+		for (int i = 0; i < n; i++) {				// Read the tour starting at start, wrapping around the end for a closed tour.
+			cout << " " << tour[(itour[start] + i) % n];
+		};
+	};
+}
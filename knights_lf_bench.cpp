@@ -0,0 +1,222 @@
+#define KNIGHTS_BENCH
+#include "knights_lf.cpp"
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+/*
+
+This program times the inner operations of knights_lf in isolation. It includes knights_lf.cpp directly (with KNIGHTS_BENCH defined, so that file's main() is left out), which gives it access to the same global arrays the solver uses.
+
+For each board size, the board is initialized and the least freedom search is run from space 0 until half of the board has been visited. That half finished tour is the fixed board state every benchmark starts from, so the numbers are reproducible from run to run. Anything a benchmark changes is put back by copying a saved snapshot of the arrays, and that copying is done outside of the timed region.
+
+The solver prints a lot "for kicks". cout is switched off while timing so the numbers measure the algorithm and not the console. Results are written to stdout as CSV, one line per benchmark and board size, so runs from different builds and compiler flags can be compared directly. Each line starts with the compiler version and the flags the program was built with (BENCH_FLAGS, passed in by the Makefile). The header line can be left out with -noheader, so the output of both benchmark programs can go into one file.
+
+*/
+
+
+
+#define BENCH_REPS 201					// Number of timed repetitions per benchmark. The median and minimum are reported.
+#define BENCH_PATH 32					// Number of visits replayed (and then backtracked) in one repetition.
+
+#ifndef BENCH_FLAGS
+#define BENCH_FLAGS "unknown"			// The compiler flags, recorded with the results.
+#endif
+#ifdef __VERSION__
+#define BENCH_COMPILER __VERSION__
+#else
+#define BENCH_COMPILER "unknown"
+#endif
+
+typedef std::chrono::steady_clock benchclock;
+
+struct Snapshot {						// A saved copy of all of the solver's state.
+	int here;
+	int in;
+	int lasts[MAXSIZE*MAXSIZE];
+	int possibles[MAXSIZE*MAXSIZE][8];
+	int ipossibles[MAXSIZE*MAXSIZE];
+	int travelled[MAXSIZE*MAXSIZE][8];
+	int itravelled[MAXSIZE*MAXSIZE];
+	bool visited[MAXSIZE*MAXSIZE];
+};
+
+static Snapshot midstate;				// The fixed half finished board state.
+static Snapshot pathstate;				// The fixed state after replaying the path out of midstate.
+static int initpossibles[MAXSIZE*MAXSIZE][8];	// The full move lists of the empty board.
+static int initipossibles[MAXSIZE*MAXSIZE];
+static volatile int sink;				// Keeps the compiler from discarding results.
+
+void save(Snapshot* s) {
+	s->here = here;
+	s->in = in;
+	memcpy(s->lasts, lasts, sizeof(lasts));
+	memcpy(s->possibles, possibles, sizeof(possibles));
+	memcpy(s->ipossibles, ipossibles, sizeof(ipossibles));
+	memcpy(s->travelled, travelled, sizeof(travelled));
+	memcpy(s->itravelled, itravelled, sizeof(itravelled));
+	memcpy(s->visited, visited, sizeof(visited));
+}
+
+void restore(const Snapshot* s) {
+	here = s->here;
+	in = s->in;
+	memcpy(lasts, s->lasts, sizeof(lasts));
+	memcpy(possibles, s->possibles, sizeof(possibles));
+	memcpy(ipossibles, s->ipossibles, sizeof(ipossibles));
+	memcpy(travelled, s->travelled, sizeof(travelled));
+	memcpy(itravelled, s->itravelled, sizeof(itravelled));
+	memcpy(visited, s->visited, sizeof(visited));
+}
+
+// Runs the same search loop as main(), from space 0, until target spaces have been visited. Records the spaces visited along the way in path, if given.
+void searchto(int target, std::vector<int>* path) {
+	while ((in < target)&&(in < n)) {
+		int next = findnext();
+		if (next >= 0) {
+			visit(next);
+			if (path) {
+				path->push_back(next);
+			};
+		} else {
+			backtrack();
+			if ((path)&&(!path->empty())) {
+				path->pop_back();
+			};
+		};
+	};
+}
+
+// Sets up the fixed board states for a w x h board, and records the path the search takes out of the half finished state.
+void setup(int size, std::vector<int>* path) {
+	w = size;
+	h = size;
+	n = w*h;
+	initialize();
+	memcpy(initpossibles, possibles, sizeof(possibles));
+	memcpy(initipossibles, ipossibles, sizeof(ipossibles));
+
+	startat(0);
+	searchto(n/2, NULL);
+	save(&midstate);
+
+	path->clear();
+	searchto(n/2 + BENCH_PATH, path);
+	save(&pathstate);
+}
+
+// Prints one CSV line, given the time taken by each repetition and the number of operations in a repetition.
+void report(const char* name, int size, int ops, std::vector<double>& times) {
+	std::sort(times.begin(), times.end());
+	printf("\"%s\",\"%s\",knights_lf,%s,%d,%d,%d,%.2f,%.2f\n", BENCH_COMPILER, BENCH_FLAGS, name, size, ops, (int)times.size(), times[times.size()/2]/ops, times[0]/ops);
+}
+
+double elapsed(benchclock::time_point start) {
+	return std::chrono::duration<double, std::nano>(benchclock::now() - start).count();
+}
+
+// findnext() only reads the board, so it is called once from every space in the half finished state.
+void benchfindnext(int size) {
+	std::vector<double> times;
+	restore(&midstate);
+	for (int r = 0; r < BENCH_REPS; r++) {
+		benchclock::time_point start = benchclock::now();
+		for (int i = 0; i < n; i++) {
+			here = i;
+			sink = findnext();
+		};
+		times.push_back(elapsed(start));
+	};
+	report("findnext", size, n, times);
+}
+
+// intravelled() only reads the board, so it is called for every legal move on the board.
+void benchintravelled(int size) {
+	std::vector<double> times;
+	int ops = 0;
+	restore(&midstate);
+	for (int r = 0; r < BENCH_REPS; r++) {
+		ops = 0;
+		benchclock::time_point start = benchclock::now();
+		for (int i = 0; i < n; i++) {
+			for (int k = 0; k < initipossibles[i]; k++) {
+				sink = intravelled(i, initpossibles[i][k]);
+				ops++;
+			};
+		};
+		times.push_back(elapsed(start));
+	};
+	report("intravelled", size, ops, times);
+}
+
+// visit() is timed by replaying the recorded path out of the half finished state.
+void benchvisit(int size, const std::vector<int>& path) {
+	std::vector<double> times;
+	for (int r = 0; r < BENCH_REPS; r++) {
+		restore(&midstate);
+		benchclock::time_point start = benchclock::now();
+		for (size_t i = 0; i < path.size(); i++) {
+			visit(path[i]);
+		};
+		times.push_back(elapsed(start));
+	};
+	report("visit", size, path.size(), times);
+}
+
+// backtrack() is timed by walking the recorded path back from its end.
+void benchbacktrack(int size, const std::vector<int>& path) {
+	std::vector<double> times;
+	for (int r = 0; r < BENCH_REPS; r++) {
+		restore(&pathstate);
+		benchclock::time_point start = benchclock::now();
+		for (size_t i = 0; i < path.size(); i++) {
+			backtrack();
+		};
+		times.push_back(elapsed(start));
+	};
+	report("backtrack", size, path.size(), times);
+}
+
+// removepossible() is timed by removing one move, from the middle of the list, out of every space that has any left.
+void benchremovepossible(int size) {
+	std::vector<double> times;
+	std::vector<int> sources;
+	std::vector<int> targets;
+	restore(&midstate);
+	for (int i = 0; i < n; i++) {
+		if (ipossibles[i] > 0) {
+			sources.push_back(i);
+			targets.push_back(possibles[i][ipossibles[i]/2]);
+		};
+	};
+	for (int r = 0; r < BENCH_REPS; r++) {
+		restore(&midstate);
+		benchclock::time_point start = benchclock::now();
+		for (size_t i = 0; i < sources.size(); i++) {
+			removepossible(sources[i], targets[i]);
+		};
+		times.push_back(elapsed(start));
+	};
+	report("removepossible", size, sources.size(), times);
+}
+
+int main (int argc, char* argv[]) {
+	int sizes[] = {6, 8, 12, 16, 20, MAXSIZE};
+	std::vector<int> path;
+
+	if (!((argc > 1)&&(strcmp(argv[1], "-noheader") == 0))) {
+		printf("compiler,flags,program,benchmark,size,ops,reps,median_ns_per_op,min_ns_per_op\n");
+	};
+	for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++) {
+		cout.setstate(ios::badbit);		// Silence the solver's printing while it runs.
+		setup(sizes[s], &path);
+		benchfindnext(sizes[s]);
+		benchintravelled(sizes[s]);
+		benchvisit(sizes[s], path);
+		benchbacktrack(sizes[s], path);
+		benchremovepossible(sizes[s]);
+		cout.clear();
+	}
+	return 0;
+}
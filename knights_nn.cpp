@@ -97,6 +97,7 @@ class Neuron {
 		Node* end;
 		void printAdjacent();
 		bool isActive();
+		void setActive(bool active);
 };
 
 
@@ -282,6 +283,11 @@ int Neuron::getprev () {
 bool Neuron::isActive() {
 	return (output == 1 ? true : false);
 }
+// Forces the output of the neuron on or off. Used to lay a known tour onto the network, for testing checkSolution.
+void Neuron::setActive(bool active) {
+	output = (active ? 1 : 0);
+	prevout = output;
+}
 // Prints a list of the nabrs of the neuron that calls it. It identifies itself by the nodes it conects, and then lists the neurons in its nabrs list by their addresses, each on their own line. Used in bugtracking.
 void Neuron::printAdjacent() {
 	cout << "\nThis neuron connects " << start->getPosition() << " with " << end->getPosition();
@@ -307,6 +313,7 @@ void Neuron::restart() {
 /*
 The operation of the code starts here.
 */
+#ifndef KNIGHTS_BENCH
 int main() {
 
 	// Gets a randomization seed from the time.
@@ -359,6 +366,7 @@ int main() {
 
 	cout << "\n\ndone";
 };
+#endif
 
 
 // This function runs the initialization of the chess board. It is called in main(). It first creates a general Node pointer, and uses that to create n^2 nodes, stored in the nodes[][] array.
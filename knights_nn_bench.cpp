@@ -0,0 +1,252 @@
+#define KNIGHTS_BENCH
+#include "knights_nn.cpp"
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+/*
+
+This program times the inner operations of knights_nn in isolation. It includes knights_nn.cpp directly (with KNIGHTS_BENCH defined, so that file's main() is left out), which gives it access to the same nodes and neurons the network uses.
+
+The network starts from random outputs, so the board states for the update and epoch benchmarks are made by seeding rand() with a fixed value before restarting the neurons. checkSolution is instead given a knight's tour, found by a small least freedom search, laid onto the network so that it has to walk the whole board. That makes the numbers reproducible from run to run. Putting a state back is done outside of the timed region.
+
+The network prints every time a neuron's output changes. cout is switched off while timing so the numbers measure the algorithm and not the console. Results are written to stdout as CSV, one line per benchmark and board size, so runs from different builds and compiler flags can be compared directly. Each line starts with the compiler version and the flags the program was built with (BENCH_FLAGS, passed in by the Makefile). The header line can be left out with -noheader, so the output of both benchmark programs can go into one file.
+
+*/
+
+
+
+#define BENCH_REPS 201					// Number of timed repetitions per benchmark. The median and minimum are reported.
+#define BENCH_SEED 12345				// Seed for the fixed board states.
+#define BENCH_EPOCHS 16					// Number of epochs run, one after another, in one repetition.
+#define BENCH_CALLS 16					// Number of checkSolution calls in one repetition.
+
+#ifndef BENCH_FLAGS
+#define BENCH_FLAGS "unknown"			// The compiler flags, recorded with the results.
+#endif
+#ifdef __VERSION__
+#define BENCH_COMPILER __VERSION__
+#else
+#define BENCH_COMPILER "unknown"
+#endif
+
+typedef std::chrono::steady_clock benchclock;
+
+static std::vector<Neuron*> neurons;	// Every neuron on the board, each listed once.
+static volatile bool sink;				// Keeps the compiler from discarding results.
+static int tourx[MAXSIZE*MAXSIZE];		// A knight's tour of the board, as the x and y of each space in order.
+static int toury[MAXSIZE*MAXSIZE];
+static bool ontour[MAXSIZE][MAXSIZE];
+static const int movex[8] = {1, 2, 2, 1, -1, -2, -2, -1};
+static const int movey[8] = {-2, -1, 1, 2, 2, 1, -1, -2};
+
+// Runs one epoch the same way main() does, by resetting and then updating every node's neurons.
+void epoch() {
+	isdone = true;
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			nodes[j][i]->resetneurons();
+		};
+	};
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			nodes[j][i]->updateneurons();
+		};
+	};
+}
+
+// Puts the network back into the fixed starting state.
+void reseed() {
+	srand(BENCH_SEED);
+	restartNodes();
+}
+
+// Builds the network for an n x n board, and makes the list of neurons. Each neuron is listed by the node at its start.
+void setup(int size) {
+	n = size;
+	srand(BENCH_SEED);
+	initialize();
+	neurons.clear();
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			for (int k = 0; k < nodes[i][j]->iadj; k++) {
+				if (nodes[i][j]->adj[k]->start == nodes[i][j]) {
+					neurons.push_back(nodes[i][j]->adj[k]);
+				};
+			};
+		};
+	};
+}
+
+// Deletes the network built by setup(), so the next board size starts clean.
+void teardown() {
+	for (size_t i = 0; i < neurons.size(); i++) {
+		delete neurons[i];
+	};
+	neurons.clear();
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			delete nodes[i][j];
+			nodes[i][j] = NULL;
+		};
+	};
+}
+
+// Prints one CSV line, given the time taken by each repetition and the number of operations in a repetition.
+void report(const char* name, int size, int ops, std::vector<double>& times) {
+	std::sort(times.begin(), times.end());
+	printf("\"%s\",\"%s\",knights_nn,%s,%d,%d,%d,%.2f,%.2f\n", BENCH_COMPILER, BENCH_FLAGS, name, size, ops, (int)times.size(), times[times.size()/2]/ops, times[0]/ops);
+}
+
+double elapsed(benchclock::time_point start) {
+	return std::chrono::duration<double, std::nano>(benchclock::now() - start).count();
+}
+
+// Neuron::update is timed by updating every neuron once, after the fixed state has been restored and every neuron reset.
+void benchupdate(int size) {
+	std::vector<double> times;
+	for (int r = 0; r < BENCH_REPS; r++) {
+		reseed();
+		for (size_t i = 0; i < neurons.size(); i++) {
+			neurons[i]->reset();
+		};
+		benchclock::time_point start = benchclock::now();
+		for (size_t i = 0; i < neurons.size(); i++) {
+			neurons[i]->update();
+		};
+		times.push_back(elapsed(start));
+	};
+	report("update", size, neurons.size(), times);
+}
+
+// Epochs are timed as a fixed run of BENCH_EPOCHS, one after another, from the fixed state. This includes the resets and the second, skipped update each neuron gets.
+void benchepoch(int size) {
+	std::vector<double> times;
+	for (int r = 0; r < BENCH_REPS; r++) {
+		reseed();
+		benchclock::time_point start = benchclock::now();
+		for (int e = 0; e < BENCH_EPOCHS; e++) {
+			epoch();
+		};
+		times.push_back(elapsed(start));
+	};
+	report("epoch", size, BENCH_EPOCHS, times);
+}
+
+// Counts the unused spaces a knight at x, y could move to. Used to pick the next space of the tour by least freedom.
+int freedom(int x, int y) {
+	int count = 0;
+	for (int k = 0; k < 8; k++) {
+		int nx = x + movex[k];
+		int ny = y + movey[k];
+		if ((nx >= 0)&&(nx < n)&&(ny >= 0)&&(ny < n)&&(!(ontour[nx][ny]))) {
+			count++;
+		};
+	};
+	return count;
+}
+
+// Extends the tour from its space at index i, trying the moves with the least freedom first and backing up out of dead ends.
+bool extendtour(int i) {
+	if (i == n*n - 1) {
+		return true;
+	};
+	int order[8];
+	int degree[8];
+	int count = 0;
+	for (int k = 0; k < 8; k++) {
+		int nx = tourx[i] + movex[k];
+		int ny = toury[i] + movey[k];
+		if ((nx >= 0)&&(nx < n)&&(ny >= 0)&&(ny < n)&&(!(ontour[nx][ny]))) {
+			int d = freedom(nx, ny);
+			int j = count;
+			while ((j > 0)&&(degree[j-1] > d)) {		// Insertion sort, so ties keep move order.
+				order[j] = order[j-1];
+				degree[j] = degree[j-1];
+				j--;
+			};
+			order[j] = k;
+			degree[j] = d;
+			count++;
+		};
+	};
+	for (int c = 0; c < count; c++) {
+		tourx[i+1] = tourx[i] + movex[order[c]];
+		toury[i+1] = toury[i] + movey[order[c]];
+		ontour[tourx[i+1]][toury[i+1]] = true;
+		if (extendtour(i+1)) {
+			return true;
+		};
+		ontour[tourx[i+1]][toury[i+1]] = false;
+	};
+	return false;
+}
+
+// Finds the neuron connecting two nodes.
+Neuron* between(Node* one, Node* two) {
+	for (int k = 0; k < one->iadj; k++) {
+		if ((one->adj[k]->start == two)||(one->adj[k]->end == two)) {
+			return one->adj[k];
+		};
+	};
+	return NULL;
+}
+
+// Lays a knight's tour starting at nodes[0][0] onto the network, switching on exactly the neurons along it. checkSolution then has to follow the tour across the whole board.
+void laytour() {
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			ontour[i][j] = false;
+		};
+	};
+	tourx[0] = 0;
+	toury[0] = 0;
+	ontour[0][0] = true;
+	extendtour(0);
+	for (size_t i = 0; i < neurons.size(); i++) {
+		neurons[i]->setActive(false);
+	};
+	for (int i = 0; i < n*n - 1; i++) {
+		between(nodes[tourx[i]][toury[i]], nodes[tourx[i+1]][toury[i+1]])->setActive(true);
+	};
+}
+
+// checkSolution is timed from nodes[0][0] with a knight's tour laid onto the network. The visited flags it sets are cleared between calls, outside of the timed region, so each call is timed on its own and added to the repetition's total.
+void benchcheckSolution(int size) {
+	std::vector<double> times;
+	laytour();
+	for (int r = 0; r < BENCH_REPS; r++) {
+		double total = 0;
+		for (int c = 0; c < BENCH_CALLS; c++) {
+			for (int i = 0; i < n; i++) {
+				for (int j = 0; j < n; j++) {
+					nodes[i][j]->visited = false;
+				};
+			};
+			benchclock::time_point start = benchclock::now();
+			sink = checkSolution(nodes[0][0]);
+			total += elapsed(start);
+		};
+		times.push_back(total);
+	};
+	report("checkSolution", size, BENCH_CALLS, times);
+}
+
+int main(int argc, char* argv[]) {
+	int sizes[] = {6, 8, 12, 16, 20, MAXSIZE};
+
+	if (!((argc > 1)&&(strcmp(argv[1], "-noheader") == 0))) {
+		printf("compiler,flags,program,benchmark,size,ops,reps,median_ns_per_op,min_ns_per_op\n");
+	};
+	for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++) {
+		cout.setstate(ios::badbit);		// Silence the network's printing while it runs.
+		setup(sizes[s]);
+		benchupdate(sizes[s]);
+		benchepoch(sizes[s]);
+		benchcheckSolution(sizes[s]);
+		teardown();
+		cout.clear();
+	}
+	return 0;
+}